@@ -0,0 +1,271 @@
+#include "app/frame_overlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "app/frame_overlay_internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PUP_OVERLAY_X86 1
+#endif
+
+namespace pup {
+
+namespace {
+
+// 5x7 点阵字体，每行低 5 位有效，bit4 为最左列
+constexpr char kGlyphChars[] = "0123456789: ";
+constexpr int kGlyphCount = sizeof(kGlyphChars) - 1;
+constexpr int kGlyphCols = 5;
+constexpr int kGlyphRows = 7;
+constexpr int kGlyphPadding = 1;
+constexpr int kTimecodeLength = sizeof("HH:MM:SS:FF NNNNNN") - 1;
+constexpr uint8_t kGlyphBitmaps[kGlyphCount][kGlyphRows] = {
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // 空格
+};
+
+// 预乘 BGRA: 白色文字，半透明黑色底
+constexpr uint8_t kTextPixel[4] = {255, 255, 255, 255};
+constexpr uint8_t kBackgroundPixel[4] = {0, 0, 0, 160};
+
+/// d * (255 - a) / 255 四舍五入，再与 s 饱和相加
+inline uint8_t BlendChannel(uint8_t s, uint8_t d, uint8_t a) {
+  unsigned t = d * (255u - a) + 128u;
+  unsigned v = s + ((t + (t >> 8)) >> 8);
+  return static_cast<uint8_t>(std::min(v, 255u));
+}
+
+inline void BlendPixels(uint8_t* dst, const uint8_t* src, int count) {
+  for (int i = 0; i < count * 4; i += 4) {
+    uint8_t a = src[i + 3];
+    for (int c = 0; c < 4; ++c) {
+      dst[i + c] = BlendChannel(src[i + c], dst[i + c], a);
+    }
+  }
+}
+
+#if defined(PUP_OVERLAY_X86)
+
+/// 8 个 16 位通道（2 像素）: d * (255 - a) / 255
+inline __m128i ScaleByInvAlpha(__m128i d, __m128i s) {
+  __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+  __m128i t = _mm_add_epi16(_mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(255), a)), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/// 每次 4 像素，返回已处理的像素数
+int BlendRowSSE2(uint8_t* dst, const uint8_t* src, int width) {
+  const __m128i zero = _mm_setzero_si128();
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) == 0xFFFF) {
+      continue;  // 全透明
+    }
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x * 4));
+    __m128i lo = ScaleByInvAlpha(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero));
+    __m128i hi = ScaleByInvAlpha(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_adds_epu8(_mm_packus_epi16(lo, hi), s));
+  }
+  return x;
+}
+
+#if defined(__GNUC__)
+#define PUP_OVERLAY_AVX2 1
+
+__attribute__((target("avx2"))) inline __m256i ScaleByInvAlpha256(__m256i d, __m256i s) {
+  __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+  __m256i t =
+      _mm256_add_epi16(_mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(255), a)), _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+/// 每次 8 像素，返回已处理的像素数（unpack/pack 均按 128 位 lane 进行，像素顺序不变）
+__attribute__((target("avx2"))) int BlendRowAVX2(uint8_t* dst, const uint8_t* src, int width) {
+  const __m256i zero = _mm256_setzero_si256();
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, zero)) == -1) {
+      continue;  // 全透明
+    }
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + x * 4));
+    __m256i lo = ScaleByInvAlpha256(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero));
+    __m256i hi = ScaleByInvAlpha256(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), _mm256_adds_epu8(_mm256_packus_epi16(lo, hi), s));
+  }
+  return x;
+}
+#endif  // defined(__GNUC__)
+
+#endif  // defined(PUP_OVERLAY_X86)
+
+internal::BlendRowFunc SelectBlendRow() {
+  if (auto avx2 = internal::GetBlendRowAVX2()) {
+    return avx2;
+  }
+  return internal::GetBlendRowSSE2();
+}
+
+/// 将 sprite 中 src 区域混合到帧的 (x, y) 处，超出帧的部分被裁掉
+void BlendClipped(uint8_t* frame, int width, int height, const Sprite& sprite, const FrameRect& src, int x, int y) {
+  // 裁剪到帧范围内
+  int left = std::max(x, 0);
+  int top = std::max(y, 0);
+  int right = std::min(x + src.width, width);
+  int bottom = std::min(y + src.height, height);
+  if (left >= right || top >= bottom) {
+    return;
+  }
+  auto frame_stride = static_cast<size_t>(width) * 4;
+  auto* dst = frame + top * frame_stride + static_cast<size_t>(left) * 4;
+  const auto* src_ptr =
+      sprite.pixels.data() + (src.y + top - y) * sprite.GetStride() + static_cast<size_t>(src.x + left - x) * 4;
+  BlendSprite(dst, frame_stride, src_ptr, sprite.GetStride(), right - left, bottom - top);
+}
+
+int GlyphIndex(char c) {
+  return c == ':' ? 10 : c == ' ' ? 11 : c - '0';
+}
+
+}  // namespace
+
+void BlendSpriteScalar(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, int width, int height) {
+  for (int row = 0; row < height; ++row) {
+    BlendPixels(dst + row * dst_stride, src + row * src_stride, width);
+  }
+}
+
+void BlendSprite(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, int width, int height) {
+  static const internal::BlendRowFunc blend_row = SelectBlendRow();
+  internal::BlendSpriteWith(blend_row, dst, dst_stride, src, src_stride, width, height);
+}
+
+namespace internal {
+
+BlendRowFunc GetBlendRowSSE2() {
+#if defined(PUP_OVERLAY_X86)
+  return &BlendRowSSE2;
+#else
+  return nullptr;
+#endif
+}
+
+BlendRowFunc GetBlendRowAVX2() {
+#if defined(PUP_OVERLAY_AVX2)
+  if (__builtin_cpu_supports("avx2")) {
+    return &BlendRowAVX2;
+  }
+#endif
+  return nullptr;
+}
+
+void BlendSpriteWith(BlendRowFunc blend_row,
+                     uint8_t* dst,
+                     size_t dst_stride,
+                     const uint8_t* src,
+                     size_t src_stride,
+                     int width,
+                     int height) {
+  if (!blend_row) {
+    BlendSpriteScalar(dst, dst_stride, src, src_stride, width, height);
+    return;
+  }
+  for (int row = 0; row < height; ++row) {
+    auto* d = dst + row * dst_stride;
+    const auto* s = src + row * src_stride;
+    int done = blend_row(d, s, width);
+    BlendPixels(d + done * 4, s + done * 4, width - done);
+  }
+}
+
+}  // namespace internal
+
+FrameOverlay::FrameOverlay(int fps) : fps_(std::max(fps, 1)) {}
+
+bool FrameOverlay::LoadWatermark(const std::filesystem::path& path, const FrameRect& rect) {
+  auto size = static_cast<size_t>(rect.width) * rect.height * 4;
+  std::error_code ec;
+  if (rect.width <= 0 || rect.height <= 0 || std::filesystem::file_size(path, ec) != size || ec) {
+    std::cerr << "Watermark " << path.string() << " does not match " << rect.width << "x" << rect.height
+              << " BGRA\n";
+    return false;
+  }
+  std::ifstream file(path, std::ios::binary);
+  watermark_.width = rect.width;
+  watermark_.height = rect.height;
+  watermark_.pixels.resize(size);
+  if (!file.read(reinterpret_cast<char*>(watermark_.pixels.data()), static_cast<std::streamsize>(size))) {
+    std::cerr << "Failed to read watermark " << path.string() << "\n";
+    watermark_ = {};
+    return false;
+  }
+  watermark_rect_ = rect;
+  return true;
+}
+
+void FrameOverlay::EnableTimecode(int x, int y, int scale) {
+  scale = std::max(scale, 1);
+  timecode_ = true;
+  timecode_x_ = x;
+  timecode_y_ = y;
+
+  // 所有 glyph 横向排成一张图集，每个单元带 padding 作为底色
+  glyph_width_ = (kGlyphCols + kGlyphPadding * 2) * scale;
+  glyph_atlas_.width = glyph_width_ * kGlyphCount;
+  glyph_atlas_.height = (kGlyphRows + kGlyphPadding * 2) * scale;
+  glyph_atlas_.pixels.resize(glyph_atlas_.GetStride() * glyph_atlas_.height);
+  for (int y_px = 0; y_px < glyph_atlas_.height; ++y_px) {
+    int row = y_px / scale - kGlyphPadding;
+    for (int x_px = 0; x_px < glyph_atlas_.width; ++x_px) {
+      int glyph = x_px / glyph_width_;
+      int col = (x_px % glyph_width_) / scale - kGlyphPadding;
+      bool on = row >= 0 && row < kGlyphRows && col >= 0 && col < kGlyphCols &&
+                (kGlyphBitmaps[glyph][row] >> (kGlyphCols - 1 - col)) & 1;
+      auto* pixel = &glyph_atlas_.pixels[y_px * glyph_atlas_.GetStride() + x_px * 4];
+      std::copy_n(on ? kTextPixel : kBackgroundPixel, 4, pixel);
+    }
+  }
+}
+
+FrameRect FrameOverlay::GetTimecodeRect() const {
+  if (!timecode_) {
+    return {};
+  }
+  return {timecode_x_, timecode_y_, glyph_width_ * kTimecodeLength, glyph_atlas_.height};
+}
+
+void FrameOverlay::Apply(uint8_t* frame, int width, int height, int frame_id) const {
+  if (!watermark_.pixels.empty()) {
+    BlendClipped(frame, width, height, watermark_, {0, 0, watermark_.width, watermark_.height}, watermark_rect_.x,
+                 watermark_rect_.y);
+  }
+  if (!timecode_) {
+    return;
+  }
+
+  int total_seconds = frame_id / fps_;
+  char text[48];
+  std::snprintf(text, sizeof(text), "%02d:%02d:%02d:%02d %06d", total_seconds / 3600, total_seconds / 60 % 60,
+                total_seconds % 60, frame_id % fps_, frame_id);
+  int x = timecode_x_;
+  for (const char* c = text; *c; ++c, x += glyph_width_) {
+    int glyph = GlyphIndex(*c);
+    BlendClipped(frame, width, height, glyph_atlas_, {glyph * glyph_width_, 0, glyph_width_, glyph_atlas_.height}, x,
+                 timecode_y_);
+  }
+}
+
+}  // namespace pup
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "app/frame_rect.h"
+
+namespace pup {
+
+/// 预乘 alpha 的 BGRA 贴图
+struct Sprite {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels;
+
+  size_t GetStride() const { return static_cast<size_t>(width) * 4; }
+};
+
+/// 将预乘 BGRA 贴图混合到目标区域: dst = src + dst * (255 - src.a) / 255
+/// 运行时选择 AVX2 / SSE2 实现，结果与 BlendSpriteScalar 逐像素一致
+void BlendSprite(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, int width, int height);
+
+/// 标量参考实现
+void BlendSpriteScalar(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, int width, int height);
+
+/// 帧叠加层（水印 + 时间码）
+/// 职责: 在写盘线程上将静态水印和逐帧时间码烧录进帧数据，省去 ffmpeg 二次编码
+class FrameOverlay {
+ public:
+  explicit FrameOverlay(int fps);
+
+  FrameOverlay(const FrameOverlay&) = delete;
+  FrameOverlay& operator=(const FrameOverlay&) = delete;
+
+  /// 加载预乘 BGRA 裸数据作为水印，放置在 rect 处（rect 宽高需与文件匹配）
+  bool LoadWatermark(const std::filesystem::path& path, const FrameRect& rect);
+
+  /// 启用时间码 "HH:MM:SS:FF NNNNNN"，glyph 按 scale 倍放大
+  void EnableTimecode(int x, int y, int scale = 3);
+
+  /// 时间码占用的区域（按 6 位帧号计），未启用时为空
+  FrameRect GetTimecodeRect() const;
+
+  bool IsEmpty() const { return watermark_.pixels.empty() && !timecode_; }
+
+  /// 叠加到帧上（只读状态，可在多个工作线程并发调用）
+  void Apply(uint8_t* frame, int width, int height, int frame_id) const;
+
+ private:
+  int fps_;
+  Sprite watermark_;
+  FrameRect watermark_rect_;
+
+  // 时间码: 启动时预先光栅化的 glyph 图集，每帧只做混合
+  bool timecode_ = false;
+  int timecode_x_ = 0;
+  int timecode_y_ = 0;
+  Sprite glyph_atlas_;
+  int glyph_width_ = 0;
+};
+
+}  // namespace pup
@@ -0,0 +1,26 @@
+#pragma once
+
+// frame_overlay 内部接口，仅供测试逐个验证各 SIMD 内核
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pup::internal {
+
+/// 行混合内核: 处理行首若干像素，返回已处理的像素数，剩余部分由调用方用标量补齐
+using BlendRowFunc = int (*)(uint8_t* dst, const uint8_t* src, int width);
+
+/// 平台不支持时返回 nullptr
+BlendRowFunc GetBlendRowSSE2();
+BlendRowFunc GetBlendRowAVX2();
+
+/// 使用指定内核混合；blend_row 为 nullptr 时全部走标量
+void BlendSpriteWith(BlendRowFunc blend_row,
+                     uint8_t* dst,
+                     size_t dst_stride,
+                     const uint8_t* src,
+                     size_t src_stride,
+                     int width,
+                     int height);
+
+}  // namespace pup::internal
@@ -0,0 +1,28 @@
+#include "app/frame_rect.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pup {
+
+FrameRect ClampRect(const FrameRect& rect, int width, int height) {
+  int left = std::clamp(rect.x, 0, width);
+  int top = std::clamp(rect.y, 0, height);
+  int right = std::clamp(rect.x + rect.width, left, width);
+  int bottom = std::clamp(rect.y + rect.height, top, height);
+  return {left, top, (right - left) & ~1, (bottom - top) & ~1};
+}
+
+void CopyRect(uint8_t* dst, const void* src, size_t stride, const FrameRect& rect) {
+  auto row_size = static_cast<size_t>(rect.width) * 4;
+  const auto* first = static_cast<const uint8_t*>(src) + rect.y * stride + static_cast<size_t>(rect.x) * 4;
+  // 只拷贝区域内的行列；整行连续时退化为单次拷贝
+  if (row_size == stride) {
+    std::memcpy(dst, first, row_size * rect.height);
+    return;
+  }
+  for (int row = 0; row < rect.height; ++row) {
+    std::memcpy(dst + row * row_size, first + row * stride, row_size);
+  }
+}
+
+}  // namespace pup
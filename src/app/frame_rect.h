@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pup {
+
+/// 帧内矩形区域（像素坐标）
+struct FrameRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+/// 将区域裁剪到 width x height 范围内；宽高向下取偶数（yuv420p 编码要求）
+FrameRect ClampRect(const FrameRect& rect, int width, int height);
+
+/// 从 BGRA 源帧（每行 stride 字节）拷贝 rect 区域到紧密排列的 dst
+void CopyRect(uint8_t* dst, const void* src, size_t stride, const FrameRect& rect);
+
+}  // namespace pup
@@ -1,9 +1,9 @@
 #include "app/frame_writer.h"
-#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include "app/frame_overlay.h"
 
 namespace pup {
 
@@ -49,13 +49,20 @@ FrameBuffer* FrameWriter::Acquire() {
   return buf;
 }
 
-void FrameWriter::Submit(const void* buffer, int frame_id, size_t size) {
+void FrameWriter::Submit(const void* buffer, int frame_id, size_t stride, const FrameRect& rect) {
+  auto row_size = static_cast<size_t>(rect.width) * 4;
+  auto size = row_size * rect.height;
+  if (size > frame_size_) {
+    return;
+  }
   auto* frame_buffer = Acquire();
   if (!frame_buffer) {
     return;
   }
-  std::memcpy(frame_buffer->GetPtr(), buffer, size);
+  CopyRect(frame_buffer->GetPtr(), buffer, stride, rect);
   frame_buffer->id = frame_id;
+  frame_buffer->width = rect.width;
+  frame_buffer->height = rect.height;
   frame_buffer->size = size;
   {
     std::scoped_lock lock(work_mutex_);
@@ -90,6 +97,11 @@ void FrameWriter::WorkerThread() {
       work_queue_.pop();
     }
 
+    // 叠加水印/时间码
+    if (overlay_) {
+      overlay_->Apply(buffer->GetPtr(), buffer->width, buffer->height, buffer->id);
+    }
+
     // 写入文件
     std::ostringstream filename;
     filename << "frame-" << std::setw(6) << std::setfill('0') << buffer->id << ".bgra";
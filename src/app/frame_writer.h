@@ -9,12 +9,17 @@
 #include <queue>
 #include <thread>
 #include <vector>
+#include "app/frame_rect.h"
 
 namespace pup {
 
+class FrameOverlay;
+
 /// 预分配的帧缓冲区
 struct FrameBuffer {
   int id = 0;
+  int width = 0;
+  int height = 0;
   size_t size = 0;
   std::unique_ptr<uint8_t[]> data;
 
@@ -36,8 +41,11 @@ class FrameWriter {
   FrameWriter(const FrameWriter&) = delete;
   FrameWriter& operator=(const FrameWriter&) = delete;
 
-  /// 提交已填充的缓冲区
-  void Submit(const void* buffer, int frame_id, size_t size);
+  /// 从源帧中裁剪 rect 区域并提交（stride 为源帧每行字节数）
+  void Submit(const void* buffer, int frame_id, size_t stride, const FrameRect& rect);
+
+  /// 设置叠加层（须在首次 Submit 之前调用），工作线程写盘前将其混合进帧
+  void SetOverlay(std::shared_ptr<const FrameOverlay> overlay) { overlay_ = std::move(overlay); }
 
   /// 等待所有帧写入完成
   void Flush();
@@ -52,6 +60,7 @@ class FrameWriter {
 
   std::filesystem::path output_dir_;
   size_t frame_size_;
+  std::shared_ptr<const FrameOverlay> overlay_;
 
   // 内存池：空闲缓冲区
   std::vector<std::unique_ptr<FrameBuffer>> all_buffers_;
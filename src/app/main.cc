@@ -1,6 +1,9 @@
 #include <include/base/cef_build.h>
 #include <include/cef_app.h>
 #include <include/wrapper/cef_library_loader.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
@@ -21,6 +24,13 @@ void PrintUsage(const char* program) {
             << "  --height=N          Video height (default: 1080)\n"
             << "  --duration=N        Recording duration in seconds (default: 5)\n"
             << "  --fps=N             Frames per second (default: 30)\n"
+            << "  --region=X,Y,W,H    Record only this pixel rectangle (repeatable)\n"
+            << "  --region=SELECTOR   Record only the element matched by CSS selector (repeatable)\n"
+            << "  --watermark=FILE    Burn in a premultiplied BGRA watermark (raw pixels)\n"
+            << "  --watermark-rect=X,Y,W,H  Watermark position and size\n"
+            << "  --timecode          Burn in timecode and frame id\n"
+            << "  --timecode-pos=X,Y  Timecode position in the output frame (default: 16,16)\n"
+            << "  --timecode-scale=N  Timecode glyph scale, 7N px high (default: 3)\n"
             << "  --help              Show this help message\n";
 }
 
@@ -32,6 +42,39 @@ std::optional<std::string> GetArgValue(const char* arg, const char* prefix) {
   return std::nullopt;
 }
 
+/// 严格解析 "X,Y,W,H" 像素矩形，不允许多余字符
+std::optional<pup::FrameRect> ParseRect(const std::string& value) {
+  pup::FrameRect rect;
+  char trailing = 0;
+  if (std::sscanf(value.c_str(), "%d,%d,%d,%d%c", &rect.x, &rect.y, &rect.width, &rect.height, &trailing) != 4) {
+    return std::nullopt;
+  }
+  return rect;
+}
+
+/// 解析 "X,Y,W,H" 像素矩形，否则视为 CSS 选择器
+pup::CaptureRegion ParseRegion(const std::string& value) {
+  pup::CaptureRegion region;
+  if (auto rect = ParseRect(value)) {
+    region.rect = *rect;
+  } else {
+    region.selector = value;
+  }
+  return region;
+}
+
+/// 只含数字、逗号、负号和空白的值一定是想写 X,Y,W,H，不能当作选择器
+bool LooksLikeRect(const std::string& value) {
+  return std::all_of(value.begin(), value.end(),
+                     [](unsigned char c) { return std::isdigit(c) || std::isspace(c) || c == ',' || c == '-'; });
+}
+
+[[noreturn]] void ExitWithUsageError(const char* program, const std::string& message) {
+  std::cerr << "Error: " << message << "\n\n";
+  PrintUsage(program);
+  std::exit(1);
+}
+
 pup::RecorderConfig ParseArgs(int argc, char* argv[]) {
   pup::RecorderConfig config{
       .url = "",
@@ -41,6 +84,7 @@ pup::RecorderConfig ParseArgs(int argc, char* argv[]) {
       .duration = 5,
       .fps = 30,
   };
+  bool has_watermark_rect = false;
 
   for (int i = 1; i < argc; ++i) {
     const char* arg = argv[i];
@@ -62,10 +106,43 @@ pup::RecorderConfig ParseArgs(int argc, char* argv[]) {
       config.duration = std::stoi(*val);
     } else if (auto val = GetArgValue(arg, "--fps=")) {
       config.fps = std::stoi(*val);
+    } else if (auto val = GetArgValue(arg, "--region=")) {
+      if (!ParseRect(*val) && LooksLikeRect(*val)) {
+        ExitWithUsageError(argv[0], "invalid --region=" + *val + ", expected X,Y,W,H or a CSS selector");
+      }
+      config.regions.push_back(ParseRegion(*val));
+    } else if (auto val = GetArgValue(arg, "--watermark=")) {
+      config.overlay.watermark = *val;
+    } else if (auto val = GetArgValue(arg, "--watermark-rect=")) {
+      auto rect = ParseRect(*val);
+      if (!rect || rect->width <= 0 || rect->height <= 0) {
+        ExitWithUsageError(argv[0], "invalid --watermark-rect=" + *val + ", expected X,Y,W,H");
+      }
+      config.overlay.watermark_rect = *rect;
+      has_watermark_rect = true;
+    } else if (std::strcmp(arg, "--timecode") == 0) {
+      config.overlay.timecode = true;
+    } else if (auto val = GetArgValue(arg, "--timecode-pos=")) {
+      auto& overlay = config.overlay;
+      char trailing = 0;
+      if (std::sscanf(val->c_str(), "%d,%d%c", &overlay.timecode_x, &overlay.timecode_y, &trailing) != 2) {
+        ExitWithUsageError(argv[0], "invalid --timecode-pos=" + *val + ", expected X,Y");
+      }
+    } else if (auto val = GetArgValue(arg, "--timecode-scale=")) {
+      char trailing = 0;
+      if (std::sscanf(val->c_str(), "%d%c", &config.overlay.timecode_scale, &trailing) != 1 ||
+          config.overlay.timecode_scale < 1) {
+        ExitWithUsageError(argv[0], "invalid --timecode-scale=" + *val + ", expected a positive integer");
+      }
     }
     // 忽略所有其他参数（CEF 子进程会传入大量内部参数）
   }
 
+  bool has_watermark = !config.overlay.watermark.empty();
+  if (has_watermark != has_watermark_rect) {
+    ExitWithUsageError(argv[0], "--watermark and --watermark-rect must be given together");
+  }
+
   return config;
 }
 
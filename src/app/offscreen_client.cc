@@ -24,6 +24,14 @@ void OffscreenClient::OnPaint([[maybe_unused]] CefRefPtr<CefBrowser> browser,
   }
 }
 
+bool OffscreenClient::OnConsoleMessage([[maybe_unused]] CefRefPtr<CefBrowser> browser,
+                                       [[maybe_unused]] cef_log_severity_t level,
+                                       const CefString& message,
+                                       [[maybe_unused]] const CefString& source,
+                                       [[maybe_unused]] int line) {
+  return console_callback_ && console_callback_(message.ToString());
+}
+
 void OffscreenClient::OnAfterCreated(CefRefPtr<CefBrowser> browser) {
   CEF_REQUIRE_UI_THREAD();
   browser_ = browser;
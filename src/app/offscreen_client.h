@@ -2,21 +2,27 @@
 
 #include <include/cef_browser.h>
 #include <include/cef_client.h>
+#include <include/cef_display_handler.h>
 #include <include/cef_life_span_handler.h>
 #include <include/cef_load_handler.h>
 #include <include/cef_render_handler.h>
 #include <include/cef_request_handler.h>
 #include <atomic>
 #include <functional>
+#include <string>
 
 namespace pup {
 
 /// 帧数据回调: (buffer, width, height)
 using OnFrameCallback = std::function<void(const void*, int, int)>;
 
+/// 控制台消息回调: 返回 true 表示消息已被消费，不再输出
+using OnConsoleCallback = std::function<bool(const std::string&)>;
+
 /// 离屏渲染 CEF 客户端
 /// 职责: 管理 CEF 浏览器生命周期，接收渲染帧并通过回调传递
 class OffscreenClient final : public CefClient,
+                              public CefDisplayHandler,
                               public CefLifeSpanHandler,
                               public CefRenderHandler,
                               public CefRequestHandler,
@@ -27,11 +33,15 @@ class OffscreenClient final : public CefClient,
   /// 设置帧回调（每次 OnPaint 时调用）
   void SetFrameCallback(OnFrameCallback callback) { frame_callback_ = std::move(callback); }
 
+  /// 设置控制台消息回调（用于从页面回传 JS 执行结果）
+  void SetConsoleCallback(OnConsoleCallback callback) { console_callback_ = std::move(callback); }
+
   /// 浏览器状态
   CefRefPtr<CefBrowser> GetBrowser() const { return browser_; }
   bool IsLoaded() const { return loaded_; }
 
   // CefClient
+  CefRefPtr<CefDisplayHandler> GetDisplayHandler() override { return this; }
   CefRefPtr<CefLifeSpanHandler> GetLifeSpanHandler() override { return this; }
   CefRefPtr<CefRenderHandler> GetRenderHandler() override { return this; }
   CefRefPtr<CefRequestHandler> GetRequestHandler() override { return this; }
@@ -46,6 +56,13 @@ class OffscreenClient final : public CefClient,
                int width,
                int height) override;
 
+  // CefDisplayHandler
+  bool OnConsoleMessage(CefRefPtr<CefBrowser> browser,
+                        cef_log_severity_t level,
+                        const CefString& message,
+                        const CefString& source,
+                        int line) override;
+
   // CefLifeSpanHandler
   void OnAfterCreated(CefRefPtr<CefBrowser> browser) override;
   void OnBeforeClose(CefRefPtr<CefBrowser> browser) override;
@@ -65,6 +82,7 @@ class OffscreenClient final : public CefClient,
   int height_;
   std::atomic<bool> loaded_{false};
   OnFrameCallback frame_callback_;
+  OnConsoleCallback console_callback_;
   CefRefPtr<CefBrowser> browser_;
 
   IMPLEMENT_REFCOUNTING(OffscreenClient);
@@ -3,16 +3,67 @@
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <sstream>
+#include "app/frame_overlay.h"
 
 namespace pup {
 
+namespace {
+
+constexpr char kRectReplyPrefix[] = "__pup_rect__";
+
+/// 转义为 JS 单引号字符串字面量
+std::string QuoteJsString(const std::string& value) {
+  std::string quoted = "'";
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+      case '\'':
+        quoted += '\\';
+        quoted += c;
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      default:
+        quoted += c;
+    }
+  }
+  return quoted + "'";
+}
+
+/// 生成查询元素位置的脚本，结果通过 console.log 回传: "<prefix> <index> [x y w h | 错误信息]"
+/// 无论选择器是否合法都会回传，避免 querySelector 抛异常时等待超时
+std::string BuildRectQuery(size_t index, const std::string& selector) {
+  std::ostringstream js;
+  js << "(function() {"
+     << "  var msg = '" << kRectReplyPrefix << " " << index << "';"
+     << "  try {"
+     << "    var e = document.querySelector(" << QuoteJsString(selector) << ");"
+     << "    if (e) {"
+     << "      var r = e.getBoundingClientRect();"
+     << "      msg += ' ' + [r.left, r.top, r.width, r.height].map(Math.round).join(' ');"
+     << "    } else {"
+     << "      msg += ' no matching element';"
+     << "    }"
+     << "  } catch (err) {"
+     << "    msg += ' invalid selector: ' + err.message;"
+     << "  }"
+     << "  console.log(msg);"
+     << "})();";
+  return js.str();
+}
+
+}  // namespace
+
 Recorder::Recorder(RecorderConfig config) : config_(std::move(config)) {}
 
 Recorder::~Recorder() = default;
 
 bool Recorder::Initialize() {
-  auto frame_size = static_cast<size_t>(config_.width) * config_.height * 4;
-  writer_ = std::make_unique<FrameWriter>(config_.output_dir, frame_size);
   client_ = new OffscreenClient(config_.width, config_.height);
 
   CefWindowInfo window_info;
@@ -23,7 +74,39 @@ bool Recorder::Initialize() {
 
   CefBrowserHost::CreateBrowser(window_info, client_, config_.url, settings, nullptr, nullptr);
 
-  return WaitForBrowser() && WaitForLoad();
+  if (!WaitForBrowser() || !WaitForLoad() || !ResolveRegions()) {
+    return false;
+  }
+
+  auto overlay = std::make_shared<FrameOverlay>(config_.fps);
+  if (!config_.overlay.watermark.empty() &&
+      !overlay->LoadWatermark(config_.overlay.watermark, config_.overlay.watermark_rect)) {
+    return false;
+  }
+  if (config_.overlay.timecode) {
+    overlay->EnableTimecode(config_.overlay.timecode_x, config_.overlay.timecode_y, config_.overlay.timecode_scale);
+  }
+
+  // 每个区域独立输出，内存池按区域大小分配
+  for (size_t i = 0; i < rects_.size(); ++i) {
+    const auto& rect = rects_[i];
+    auto output_dir = config_.regions.empty() ? config_.output_dir
+                                              : config_.output_dir / ("region-" + std::to_string(i));
+    auto frame_size = static_cast<size_t>(rect.width) * rect.height * 4;
+    auto writer = std::make_unique<FrameWriter>(output_dir, frame_size);
+    if (!overlay->IsEmpty()) {
+      writer->SetOverlay(overlay);
+    }
+    writers_.push_back(std::move(writer));
+    std::cout << "> Region " << i << ": " << rect.width << "x" << rect.height << "+" << rect.x << "+" << rect.y
+              << " -> " << output_dir.string() << "\n";
+    if (auto tc = overlay->GetTimecodeRect();
+        tc.width > 0 && (tc.x + tc.width > rect.width || tc.y + tc.height > rect.height)) {
+      std::cerr << "> Warning: region " << i << " is smaller than the timecode (" << tc.width << "x" << tc.height
+                << "+" << tc.x << "+" << tc.y << "), it will be clipped; see --timecode-pos/--timecode-scale\n";
+    }
+  }
+  return true;
 }
 
 bool Recorder::WaitForBrowser() {
@@ -50,11 +133,78 @@ bool Recorder::WaitForLoad() {
   return true;
 }
 
+bool Recorder::ResolveRegions() {
+  if (config_.regions.empty()) {
+    rects_ = {FrameRect{0, 0, config_.width, config_.height}};
+    return true;
+  }
+
+  rects_.assign(config_.regions.size(), FrameRect{});
+  std::vector<bool> found(config_.regions.size(), false);
+  std::vector<std::string> errors(config_.regions.size(), "no reply from page");
+  auto pending = 0;
+
+  // 先安装回调再发起查询，不依赖消息循环的调度顺序
+  client_->SetConsoleCallback([&](const std::string& message) {
+    std::istringstream reply(message);
+    std::string prefix;
+    size_t index = 0;
+    if (!(reply >> prefix >> index) || prefix != kRectReplyPrefix || index >= rects_.size()) {
+      return false;
+    }
+    FrameRect rect;
+    if (reply >> rect.x >> rect.y >> rect.width >> rect.height) {
+      rects_[index] = rect;
+      found[index] = true;
+    } else {
+      reply.clear();
+      std::getline(reply >> std::ws, errors[index]);
+    }
+    pending -= 1;
+    return true;
+  });
+
+  auto frame = client_->GetBrowser()->GetMainFrame();
+  for (size_t i = 0; i < config_.regions.size(); ++i) {
+    const auto& region = config_.regions[i];
+    if (region.selector.empty()) {
+      rects_[i] = region.rect;
+      found[i] = true;
+      continue;
+    }
+    frame->ExecuteJavaScript(BuildRectQuery(i, region.selector), frame->GetURL(), 0);
+    pending += 1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  while (pending > 0) {
+    CefDoMessageLoopWork();
+    if (std::chrono::steady_clock::now() - start > std::chrono::seconds(10)) {
+      std::cerr << "Region selector timeout\n";
+      break;
+    }
+  }
+  client_->SetConsoleCallback(nullptr);
+
+  for (size_t i = 0; i < rects_.size(); ++i) {
+    if (!found[i]) {
+      std::cerr << "Region " << i << ": selector not resolved: " << config_.regions[i].selector << " ("
+                << errors[i] << ")\n";
+      return false;
+    }
+    rects_[i] = ClampRect(rects_[i], config_.width, config_.height);
+    if (rects_[i].width <= 0 || rects_[i].height <= 0) {
+      std::cerr << "Region " << i << " is empty after clamping to the view\n";
+      return false;
+    }
+  }
+  return true;
+}
+
 bool Recorder::Record() {
   auto record_start_time = std::chrono::steady_clock::now();
   auto target_frames = config_.duration * config_.fps;
   auto frame_count = 0;
-  auto frame_size = static_cast<size_t>(config_.width) * config_.height * 4;
   auto host = client_->GetBrowser()->GetHost();
   auto frame_interval = std::chrono::milliseconds(1000 / config_.fps);
   std::optional<std::chrono::steady_clock::time_point> target_frame_time;
@@ -75,7 +225,10 @@ bool Recorder::Record() {
     if (frame_count >= target_frames) {
       return;
     }
-    writer_->Submit(buffer, frame_count, frame_size);
+    auto stride = static_cast<size_t>(w) * 4;
+    for (size_t i = 0; i < writers_.size(); ++i) {
+      writers_[i]->Submit(buffer, frame_count, stride, rects_[i]);
+    }
     frame_count += 1;
     target_frame_time = timestamp + frame_interval;
     host->Invalidate(PET_VIEW);
@@ -87,11 +240,15 @@ bool Recorder::Record() {
   }
 
   client_->SetFrameCallback(nullptr);
-  writer_->Flush();
+  for (auto& writer : writers_) {
+    writer->Flush();
+  }
 
   auto elapsed = std::chrono::steady_clock::now() - record_start_time;
   auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
-  std::cout << "> Total frames recorded: " << writer_->GetWrittenCount() << "\n";
+  for (size_t i = 0; i < writers_.size(); ++i) {
+    std::cout << "> Region " << i << ": frames recorded: " << writers_[i]->GetWrittenCount() << "\n";
+  }
   std::cout << "> Total frame time: " << diff << "ms\n";
   std::cout << "> Average frame time: " << diff / frame_count << "ms\n";
 
@@ -106,7 +263,7 @@ void Recorder::Shutdown() {
       CefDoMessageLoopWork();
     }
   }
-  writer_.reset();
+  writers_.clear();
   client_ = nullptr;
 }
 
@@ -3,11 +3,28 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 #include "app/frame_writer.h"
 #include "app/offscreen_client.h"
 
 namespace pup {
 
+/// 录制区域: 像素矩形，或在页面加载完成后解析一次的 CSS 选择器
+struct CaptureRegion {
+  FrameRect rect;
+  std::string selector;  // 非空时忽略 rect
+};
+
+/// 烧录叠加层: 静态水印 + 逐帧时间码
+struct OverlayConfig {
+  std::filesystem::path watermark;  // 预乘 BGRA 裸数据，为空时不加水印
+  FrameRect watermark_rect;         // 位置及尺寸（相对输出帧）
+  bool timecode = false;
+  int timecode_x = 16;
+  int timecode_y = 16;
+  int timecode_scale = 3;  // 5x7 点阵放大倍数
+};
+
 struct RecorderConfig {
   std::string url;
   std::filesystem::path output_dir;
@@ -15,6 +32,8 @@ struct RecorderConfig {
   int height = 720;
   int duration = 5;  // 秒
   int fps = 30;
+  std::vector<CaptureRegion> regions;  // 为空时录制整个视图，否则每个区域单独输出到 region-N
+  OverlayConfig overlay;
 };
 
 /// 录屏控制器
@@ -31,10 +50,12 @@ class Recorder {
  private:
   bool WaitForBrowser();
   bool WaitForLoad();
+  bool ResolveRegions();
 
   RecorderConfig config_;
   CefRefPtr<OffscreenClient> client_;
-  std::unique_ptr<FrameWriter> writer_;
+  std::vector<FrameRect> rects_;
+  std::vector<std::unique_ptr<FrameWriter>> writers_;  // 与 rects_ 一一对应
 };
 
 }  // namespace pup
@@ -0,0 +1,116 @@
+// FrameOverlay 混合测试: SIMD 路径须与标量参考实现逐字节一致
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "app/frame_overlay.h"
+#include "app/frame_overlay_internal.h"
+
+namespace {
+
+/// 检查通道公式: round(s + d * (255 - a) / 255)，饱和到 255
+bool CheckChannelMath() {
+  std::vector<uint8_t> src(4), dst(4);
+  for (int a = 0; a < 256; ++a) {
+    for (int s = 0; s < 256; ++s) {
+      for (int d = 0; d < 256; ++d) {
+        src = {static_cast<uint8_t>(s), 0, 0, static_cast<uint8_t>(a)};
+        dst = {static_cast<uint8_t>(d), 0, 0, 0};
+        pup::BlendSpriteScalar(dst.data(), 4, src.data(), 4, 1, 1);
+        auto expected = std::min(std::lround(s + d * (255 - a) / 255.0), 255L);
+        if (dst[0] != expected) {
+          std::cerr << "channel mismatch: s=" << s << " d=" << d << " a=" << a << " got=" << int{dst[0]}
+                    << " expected=" << expected << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// 随机预乘贴图；按 8 像素分块，部分块全透明以覆盖 SIMD 跳过分支
+void FillSprite(std::mt19937& rng, std::vector<uint8_t>& pixels, size_t stride, int width, int height) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (x % 8 == 0 && rng() % 3 == 0) {
+        x += 7;  // 保持该块为全 0
+        continue;
+      }
+      auto* p = &pixels[y * stride + x * 4];
+      uint8_t a = rng() % 4 == 0 ? 255 : rng() % 256;
+      for (int c = 0; c < 3; ++c) {
+        p[c] = static_cast<uint8_t>(rng() % (a + 1));
+      }
+      p[3] = a;
+    }
+  }
+}
+
+using BlendFunc = std::function<void(uint8_t*, size_t, const uint8_t*, size_t, int, int)>;
+
+/// 随机贴图经 blend 混合后与 BlendSpriteScalar 逐字节比较
+bool CheckMatchesScalar(const char* name, const BlendFunc& blend) {
+  std::mt19937 rng(20261018);
+  for (int iter = 0; iter < 5000; ++iter) {
+    int width = 1 + static_cast<int>(rng() % 70);
+    int height = 1 + static_cast<int>(rng() % 6);
+    size_t src_stride = static_cast<size_t>(width + rng() % 5) * 4;
+    size_t dst_stride = static_cast<size_t>(width + rng() % 5) * 4;
+
+    std::vector<uint8_t> src(src_stride * height, 0);
+    FillSprite(rng, src, src_stride, width, height);
+    std::vector<uint8_t> expected(dst_stride * height);
+    for (auto& v : expected) {
+      v = static_cast<uint8_t>(rng());
+    }
+    auto actual = expected;
+
+    pup::BlendSpriteScalar(expected.data(), dst_stride, src.data(), src_stride, width, height);
+    blend(actual.data(), dst_stride, src.data(), src_stride, width, height);
+    if (actual != expected) {
+      std::cerr << name << " mismatch: width=" << width << " height=" << height << " src_stride=" << src_stride
+                << " dst_stride=" << dst_stride << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+/// 逐个内核（含标量回退）及运行时分派入口分别与标量参考比较
+bool CheckKernelsMatchScalar() {
+  struct Kernel {
+    const char* name;
+    pup::internal::BlendRowFunc func;
+    bool is_scalar;
+  };
+  const Kernel kernels[] = {
+      {"avx2", pup::internal::GetBlendRowAVX2(), false},
+      {"sse2", pup::internal::GetBlendRowSSE2(), false},
+      {"scalar", nullptr, true},
+  };
+  for (const auto& kernel : kernels) {
+    if (!kernel.func && !kernel.is_scalar) {
+      std::cout << kernel.name << ": not available, skipped\n";
+      continue;
+    }
+    auto blend = [&](uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, int width, int height) {
+      pup::internal::BlendSpriteWith(kernel.func, dst, dst_stride, src, src_stride, width, height);
+    };
+    if (!CheckMatchesScalar(kernel.name, blend)) {
+      return false;
+    }
+  }
+  return CheckMatchesScalar("BlendSprite", &pup::BlendSprite);
+}
+
+}  // namespace
+
+int main() {
+  bool ok = CheckChannelMath() && CheckKernelsMatchScalar();
+  std::cout << (ok ? "frame_overlay_test passed\n" : "frame_overlay_test FAILED\n");
+  return ok ? 0 : 1;
+}
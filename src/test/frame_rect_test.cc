@@ -0,0 +1,85 @@
+// 区域裁剪测试: ClampRect 的边界/偶数处理，CopyRect 的 stride 感知拷贝
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "app/frame_rect.h"
+
+namespace {
+
+bool operator==(const pup::FrameRect& a, const pup::FrameRect& b) {
+  return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+bool CheckClamp(const pup::FrameRect& rect, int width, int height, const pup::FrameRect& expected) {
+  auto actual = pup::ClampRect(rect, width, height);
+  if (actual == expected) {
+    return true;
+  }
+  std::cerr << "ClampRect(" << rect.x << "," << rect.y << "," << rect.width << "," << rect.height << ") = "
+            << actual.x << "," << actual.y << "," << actual.width << "," << actual.height << ", expected "
+            << expected.x << "," << expected.y << "," << expected.width << "," << expected.height << "\n";
+  return false;
+}
+
+bool CheckClampRect() {
+  return CheckClamp({0, 0, 640, 360}, 1920, 1080, {0, 0, 640, 360}) &&
+         CheckClamp({10, 20, 101, 51}, 1920, 1080, {10, 20, 100, 50}) &&         // 奇数宽高向下取偶
+         CheckClamp({-5, -7, 20, 20}, 1920, 1080, {0, 0, 14, 12}) &&             // 左上越界
+         CheckClamp({1900, 1070, 100, 100}, 1920, 1080, {1900, 1070, 20, 10}) &&  // 右下越界
+         CheckClamp({2000, 0, 10, 10}, 1920, 1080, {1920, 0, 0, 10}) &&           // 完全在视图外
+         CheckClamp({0, 0, 1, 1}, 1920, 1080, {0, 0, 0, 0});
+}
+
+/// 像素值由坐标决定，便于逐字节比较
+uint8_t PatternByte(int x, int y, int c) {
+  return static_cast<uint8_t>(x * 7 + y * 13 + c * 61);
+}
+
+bool CheckCopy(int frame_width, int frame_height, size_t stride, const pup::FrameRect& rect) {
+  std::vector<uint8_t> frame(stride * frame_height, 0xEE);
+  for (int y = 0; y < frame_height; ++y) {
+    for (int x = 0; x < frame_width; ++x) {
+      for (int c = 0; c < 4; ++c) {
+        frame[y * stride + x * 4 + c] = PatternByte(x, y, c);
+      }
+    }
+  }
+
+  // 多留一行哨兵，检查没有越界写
+  std::vector<uint8_t> out(static_cast<size_t>(rect.width) * (rect.height + 1) * 4, 0xCD);
+  pup::CopyRect(out.data(), frame.data(), stride, rect);
+  size_t i = 0;
+  for (int y = 0; y < rect.height; ++y) {
+    for (int x = 0; x < rect.width; ++x) {
+      for (int c = 0; c < 4; ++c, ++i) {
+        if (out[i] != PatternByte(rect.x + x, rect.y + y, c)) {
+          std::cerr << "CopyRect mismatch at " << x << "," << y << " stride=" << stride << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  for (; i < out.size(); ++i) {
+    if (out[i] != 0xCD) {
+      std::cerr << "CopyRect wrote past the region, stride=" << stride << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckCopyRect() {
+  return CheckCopy(64, 48, 64 * 4, {0, 0, 64, 48}) &&       // 整帧，单次拷贝路径
+         CheckCopy(64, 48, 64 * 4, {0, 5, 64, 7}) &&        // 整行但有行偏移
+         CheckCopy(64, 48, 64 * 4, {3, 5, 17, 9}) &&        // 偏移原点，奇数宽高
+         CheckCopy(61, 33, 64 * 4 + 12, {7, 11, 31, 13}) &&  // 带 padding 的 stride
+         CheckCopy(61, 33, 64 * 4 + 12, {60, 32, 1, 1});    // 右下角单像素
+}
+
+}  // namespace
+
+int main() {
+  bool ok = CheckClampRect() && CheckCopyRect();
+  std::cout << (ok ? "frame_rect_test passed\n" : "frame_rect_test FAILED\n");
+  return ok ? 0 : 1;
+}